@@ -11,7 +11,9 @@ void CustomKBMOverlay::onLoad()
 {
 	_globalCvarManager = cvarManager;
 	startTime = std::chrono::steady_clock::now();
+	auto loadStart = startTime;
 	bgMutex = std::make_unique<std::mutex>();
+	mipBuilder.Start();
 
 	// Asset Verification
 	fs::path dataFolder = gameWrapper->GetDataFolder() / "CustomKBMOverlay";
@@ -24,6 +26,15 @@ void CustomKBMOverlay::onLoad()
 	cvarX = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_overlay_x",     "0.05", "X position of the KBM overlay (0.0 to 1.0)", true, true, 0.0f, true, 1.0f));
 	cvarY = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_overlay_y",     "0.7",  "Y position of the KBM overlay (0.0 to 1.0)", true, true, 0.0f, true, 1.0f));
 	cvarScale = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_overlay_scale", "1.0",  "Scale of the KBM overlay",                   true, true, 0.1f, true, 5.0f));
+	targetMipLevel = pendingMipLevel = GetMipLevelForScale(cvarScale->getFloatValue());
+	cvarScale->addOnValueChanged([this](std::string, CVarWrapper cvar) {
+		int level = GetMipLevelForScale(cvar.getFloatValue());
+		// Applied from Render once the scale has settled, so dragging the slider doesn't reload on every step
+		gameWrapper->Execute([this, level](GameWrapper* gw) {
+			pendingMipLevel = level;
+			mipLevelChangedAt = std::chrono::steady_clock::now();
+		});
+	});
 
 	// Opacity CVars
 	cvarDesignOpacity = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_design_opacity", "0.85", "Opacity of the base design/template image (0.0 to 1.0)", true, true, 0.0f, true, 1.0f));
@@ -52,7 +63,7 @@ void CustomKBMOverlay::onLoad()
 	auto bgReload = [this](std::string varName, CVarWrapper cvar) {
 		std::string bgPath = cvar.getStringValue();
 		gameWrapper->Execute([this, bgPath](GameWrapper* gw) {
-			LoadOverlayImage(bgPath);
+			QueueOverlayLoad(bgPath);
 		});
 	};
 	cvarManager->getCvar("kbm_overlay_image_full").addOnValueChanged(bgReload);
@@ -63,6 +74,7 @@ void CustomKBMOverlay::onLoad()
 		std::string folderName = cvar.getStringValue();
 		gameWrapper->Execute([this, folderName](GameWrapper* gw) {
 			LoadBackgroundSequence(folderName);
+			if (!loadQueue.empty()) reportLoadBatch = true;
 		});
 	};
 	cvarBgFolder->addOnValueChanged(animBgReload);
@@ -71,9 +83,22 @@ void CustomKBMOverlay::onLoad()
 	cvarReactiveRgb->bindTo(std::make_shared<bool>());
 	cvarBoostColor = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_boost_color", "#FF7800", "Color of the keys while Boosting"));
 	cvarSupersonicColor = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_supersonic_color", "#00FFFF", "Color of the keys while Supersonic"));
+	cvarBoostGradient = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_boost_gradient", "0", "Dim the boost color as the boost meter empties", true, true, 0, true, 1));
+	cvarBoostGradient->bindTo(std::make_shared<bool>());
+	cvarStateRate = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_state_sample_rate", "30", "How many times per second game state (boost/supersonic) is sampled", true, true, 1.0f, true, 120.0f));
 	cvarShowKpm = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_show_kpm", "1", "Show Keys Per Minute counter", true, true, 0, true, 1));
 	cvarShowKpm->bindTo(std::make_shared<bool>());
 
+	// Hot reload: re-decode layout/background textures when their files change on disk
+	cvarHotReload = std::make_shared<CVarWrapper>(cvarManager->registerCvar("kbm_hot_reload", "1", "Automatically reload layout and background images when they change on disk", true, true, 0, true, 1));
+	cvarHotReload->bindTo(std::make_shared<bool>());
+	cvarHotReload->addOnValueChanged([this](std::string, CVarWrapper) {
+		gameWrapper->Execute([this](GameWrapper* gw) {
+			WatchLayoutFolder();
+			WatchBackgroundFolder();
+		});
+	});
+
 	// Hot-reload overlay image when path changes
 	// This old hook is replaced by the new bgReload lambda for specific layout images
 	// cvarManager->getCvar("kbm_overlay_image").addOnValueChanged([this](std::string, CVarWrapper cvar) {
@@ -83,36 +108,130 @@ void CustomKBMOverlay::onLoad()
 	// 	});
 	// });
 
+	cvarManager->registerNotifier("kbm_load_report", [this](std::vector<std::string> args) {
+		LogLoadReport(true);
+	}, "Log how long each overlay asset took to load", PERMISSION_ALL);
+
+	// Nothing is decoded here, textures stream in from Render (base layer first)
+	QueueOverlayLoad(cvarManager->getCvar(GetImageCVarName()).getStringValue());
 	LoadAllImages();
-	LoadOverlayImage(cvarManager->getCvar(GetImageCVarName()).getStringValue());
 	LoadBackgroundSequence(cvarManager->getCvar("kbm_background_folder").getStringValue());
+	reportLoadBatch = true;
 
 	lastRenderTime = std::chrono::steady_clock::now();
 
 	gameWrapper->RegisterDrawable(std::bind(&CustomKBMOverlay::Render, this, std::placeholders::_1));
 	gameWrapper->HookEvent("Function TAGame.Car_TA.SetVehicleInput", std::bind(&CustomKBMOverlay::OnSetVehicleInput, this, std::placeholders::_1));
+	gameWrapper->HookEventWithCaller<CarWrapper>("Function TAGame.Car_TA.EventVehicleSetup", [this](CarWrapper car, void* params, std::string eventName) {
+		// A new local car (spawn, team switch, reset) replaces the cached one
+		if (IsCachedCar(car)) InvalidateCarCache();
+		else if (cachedCar && car.memory_address == gameWrapper->GetLocalCar().memory_address) InvalidateCarCache();
+	});
+	gameWrapper->HookEventWithCaller<CarWrapper>("Function TAGame.Car_TA.EventDemolished", [this](CarWrapper car, void* params, std::string eventName) {
+		if (IsCachedCar(car)) InvalidateCarCache();
+	});
+	gameWrapper->HookEvent("Function TAGame.GameEvent_Soccar_TA.Destroyed", [this](std::string eventName) {
+		// No more ticks will come to refresh the state, so clear it as well
+		InvalidateCarCache();
+		gameState.Store(GameStateSample());
+	});
+
+	float onLoadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+	cvarManager->log("onLoad took " + std::to_string(onLoadMs) + " ms, " + std::to_string(loadQueue.size()) + " assets queued.");
 }
 
 void CustomKBMOverlay::onUnload()
 {
 	gameWrapper->UnhookEvent("Function TAGame.Car_TA.SetVehicleInput");
+	gameWrapper->UnhookEvent("Function TAGame.Car_TA.EventVehicleSetup");
+	gameWrapper->UnhookEvent("Function TAGame.Car_TA.EventDemolished");
+	gameWrapper->UnhookEvent("Function TAGame.GameEvent_Soccar_TA.Destroyed");
+	loadQueue.clear();
+	mipBuilder.Stop();
+	layoutWatcher.Stop();
+	bgWatcher.Stop();
 }
 
 void CustomKBMOverlay::OnSetVehicleInput(std::string eventName)
 {
-	if (!gameWrapper->IsInGame() && !gameWrapper->IsInFreeplay()) return;
+	// This fires every physics tick for every car, only sample at the configured rate
+	auto now = std::chrono::steady_clock::now();
+	float interval = 1.0f / cvarStateRate->getFloatValue();
+	if (std::chrono::duration<float>(now - lastStateSample).count() < interval) return;
+	lastStateSample = now;
+
+	// Left the match/freeplay by a path none of the hooked events covered (replays, other modes)
+	if (!gameWrapper->IsInGame() && !gameWrapper->IsInFreeplay()) {
+		if (cachedCar) {
+			InvalidateCarCache();
+			gameState.Store(GameStateSample());
+		}
+		return;
+	}
 
-	ServerWrapper server = gameWrapper->GetCurrentGameState();
-	if (!server) return;
+	// The car/boost wrappers are looked up once and reused until a car or match event invalidates them.
+	// IsNull() only catches an unset wrapper, not a destroyed actor, so once a second the cache is also
+	// compared with the current local car. That catches despawns the hooks miss (kickoff respawns,
+	// team switches where setup fires before possession, spectating and replays).
+	if (cachedCar && now - lastCarCheck >= std::chrono::seconds(1)) {
+		lastCarCheck = now;
+		CarWrapper localCar = gameWrapper->GetLocalCar();
+		if (!localCar) {
+			InvalidateCarCache();
+			gameState.Store(GameStateSample());
+			return;
+		}
+		if (localCar.memory_address != cachedCar->memory_address) {
+			InvalidateCarCache();
+		}
+		else {
+			BoostWrapper boost = localCar.GetBoostComponent();
+			if (!boost) cachedBoost.reset();
+			else if (!cachedBoost || boost.memory_address != cachedBoost->memory_address) cachedBoost.emplace(boost);
+		}
+	}
+	if (cachedCar && cachedCar->IsNull()) InvalidateCarCache();
+	if (cachedBoost && cachedBoost->IsNull()) cachedBoost.reset();
 
-	CarWrapper car = gameWrapper->GetLocalCar();
-	if (!car) return;
+	if (!cachedCar) {
+		ServerWrapper server = gameWrapper->GetCurrentGameState();
+		if (!server) return;
 
-	bIsSupersonic = car.GetbSuperSonic();
-	
-	// CarWrapper doesn't have a direct bBoost flag, we have to get the attached BoostComponent
-	BoostWrapper boost = car.GetBoostComponent();
-	bIsBoosting = (boost && boost.GetbActive());
+		CarWrapper car = gameWrapper->GetLocalCar();
+		if (!car) return;
+
+		cachedCar.emplace(car);
+		lastCarCheck = now;
+	}
+
+	// CarWrapper doesn't have a direct bBoost flag, we have to get the attached BoostComponent.
+	// It can be missing right after spawn, so keep retrying until it shows up.
+	if (!cachedBoost) {
+		BoostWrapper boost = cachedCar->GetBoostComponent();
+		if (boost) cachedBoost.emplace(boost);
+	}
+
+	GameStateSample sample;
+	sample.supersonic = cachedCar->GetbSuperSonic();
+	sample.speed = cachedCar->GetVelocity().magnitude();
+	if (cachedBoost) {
+		sample.boosting = cachedBoost->GetbActive();
+		sample.boostAmount = cachedBoost->GetCurrentBoostAmount();
+	}
+	gameState.Store(sample);
+}
+
+bool CustomKBMOverlay::IsCachedCar(CarWrapper& car)
+{
+	return cachedCar && car && car.memory_address == cachedCar->memory_address;
+}
+
+void CustomKBMOverlay::InvalidateCarCache()
+{
+	// Keep publishing the last sample, the next tick resamples straight away
+	cachedCar.reset();
+	cachedBoost.reset();
+	lastStateSample = {};
 }
 
 void CustomKBMOverlay::SetImGuiContext(uintptr_t ctx)
@@ -132,35 +251,193 @@ std::string CustomKBMOverlay::GetImageCVarName()
 	return "kbm_overlay_image_full";
 }
 
-std::shared_ptr<ImageWrapper> CustomKBMOverlay::LoadImageTemplate(std::string filename)
+std::string CustomKBMOverlay::GetLayoutSubDir()
 {
 	int profile = cvarManager->getCvar("kbm_layout_profile").getIntValue();
-	std::string subDir = "";
-	if (profile == 1) subDir = "layouts/wasd/";
-	else if (profile == 2) subDir = "layouts/mouse/";
+	if (profile == 1) return "layouts/wasd/";
+	if (profile == 2) return "layouts/mouse/";
+	return "";
+}
 
-	std::string fullPath = "CustomKBMOverlay/" + subDir + filename;
-	auto img = std::make_shared<ImageWrapper>(gameWrapper->GetDataFolder() / fullPath, true);
-	return img;
+fs::path CustomKBMOverlay::GetLayoutImagePath(const std::string& filename)
+{
+	return gameWrapper->GetDataFolder() / ("CustomKBMOverlay/" + GetLayoutSubDir() + filename);
 }
 
-void CustomKBMOverlay::LoadAllImages()
+void CustomKBMOverlay::LoadDesignImage()
 {
-	std::vector<std::string> keyNames = {
-		"esc", "1", "2", "3", "4", "5",
-		"tab", "q", "w", "e", "r", "t",
-		"caps", "a", "s", "d", "f", "g",
-		"shift", "z", "x", "c", "v", "b",
-		"ctrl", "alt", "space",
-		"mouse_left", "mouse_right", "mouse_4", "mouse_5"
-	};
+	fs::path path = gameWrapper->GetDataFolder() / currentOverlayPath;
+	LoadMipImage(path, LoadStage::Base, [this, path](std::shared_ptr<ImageWrapper> image, int level) {
+		// The design may have been switched while its mip was building
+		if (path != gameWrapper->GetDataFolder() / currentOverlayPath) return;
+		overlayImage = image;
+		overlayMipLevel = level;
+	});
+}
+
+void CustomKBMOverlay::LoadOutlinesImage()
+{
+	fs::path path = GetLayoutImagePath("keyboard_outlines.png");
+	LoadMipImage(path, LoadStage::Base, [this, path](std::shared_ptr<ImageWrapper> image, int level) {
+		if (path != GetLayoutImagePath("keyboard_outlines.png")) return;
+		outlinesImage = image;
+		outlinesMipLevel = level;
+	});
+}
+
+void CustomKBMOverlay::LoadKeySprite(const std::string& key)
+{
+	fs::path path = GetLayoutImagePath(key + "_pressed.png");
+	LoadMipImage(path, LoadStage::Keys, [this, key, path](std::shared_ptr<ImageWrapper> image, int level) {
+		if (path != GetLayoutImagePath(key + "_pressed.png")) return;
+		KeyImages& kImages = keys[key];
+		kImages.pressed = image;
+		kImages.mipLevel = level;
+	});
+}
+
+// ---------------------------------------------------------------------------
+// Mip levels
+// ---------------------------------------------------------------------------
+
+int CustomKBMOverlay::GetMipLevelForScale(float scale)
+{
+	// Smallest level that is still at least as large as the drawn size, so we only ever downscale
+	int level = 0;
+	while (level < 3 && scale <= 0.5f) {
+		scale *= 2.0f;
+		level++;
+	}
+	return level;
+}
+
+fs::path CustomKBMOverlay::GetMipPath(const fs::path& path, int level)
+{
+	if (level <= 0) return path;
+	return path.parent_path() / ("mip" + std::to_string(level)) / path.filename();
+}
+
+int CustomKBMOverlay::ResolveMipLevel(const fs::path& path)
+{
+	// Level a texture would be loaded at right now; missing sources fall back to the full-size path
+	return targetMipLevel > 0 && fs::exists(path) ? targetMipLevel : 0;
+}
+
+void CustomKBMOverlay::LoadMipImage(const fs::path& path, LoadStage stage, ApplyImage apply)
+{
+	// Full size, or a mip that is already up to date, decodes right away
+	int level = ResolveMipLevel(path);
+	fs::path mipPath = GetMipPath(path, level);
+	if (level == 0 || IsMipCurrent(path, mipPath)) {
+		apply(std::make_shared<ImageWrapper>(mipPath, true), level);
+		return;
+	}
+
+	// Otherwise the mip is (re)built on the worker and only the decode comes back to the
+	// load queue. The caller's current texture keeps drawing until then.
+	mipBuilder.Request(path, mipPath, level, [this, path, mipPath, level, stage, apply](bool ok) {
+		gameWrapper->Execute([this, path, mipPath, level, stage, apply, ok](GameWrapper* gw) {
+			// Scale changed again while this was building, ApplyMipLevel has asked for the new level
+			if (level != targetMipLevel) return;
+			if (!ok) cvarManager->log("Unable to build mip" + std::to_string(level) + " for " + path.string() + ", using full resolution.");
+
+			QueueLoad(stage, path.filename().string(), [path, mipPath, level, apply, ok]() {
+				if (ok) apply(std::make_shared<ImageWrapper>(mipPath, true), level);
+				else apply(std::make_shared<ImageWrapper>(path, true), 0);
+			});
+		});
+	});
+}
+
+void CustomKBMOverlay::ApplyMipLevel(int level)
+{
+	targetMipLevel = level;
 
-	for (const auto& key : keyNames) {
+	// Only textures whose level actually changes are reloaded; the current ones
+	// keep drawing (at their old level) until the replacements are decoded.
+	// Anything still queued picks up the new level when its job runs.
+	if (overlayImage && overlayMipLevel != ResolveMipLevel(gameWrapper->GetDataFolder() / currentOverlayPath)) {
+		QueueLayoutImage(fs::path(currentOverlayPath).filename().string());
+	}
+	if (outlinesImage && outlinesMipLevel != ResolveMipLevel(GetLayoutImagePath("keyboard_outlines.png"))) {
+		QueueLayoutImage("keyboard_outlines.png");
+	}
+
+	for (const auto& pair : keys) {
+		std::string name = pair.first + "_pressed.png";
+		if (pair.second.pressed && pair.second.mipLevel != ResolveMipLevel(GetLayoutImagePath(name))) {
+			QueueLayoutImage(name);
+		}
+	}
+
+	// Background frames are swapped as a set, restream only if a decoded frame is at the wrong level
+	bool bgStale = false;
+	for (size_t i = 0; i < backgroundFrames.size() && !bgStale; i++) {
+		bgStale = backgroundFrames[i] && backgroundFrameMipLevels[i] != ResolveMipLevel(backgroundFramePaths[i]);
+	}
+	for (size_t i = 0; i < pendingBgFrames.size() && !bgStale; i++) {
+		bgStale = pendingBgFrames[i] && pendingBgFrameMipLevels[i] != ResolveMipLevel(pendingBgFramePaths[i]);
+	}
+	if (bgStale) LoadBackgroundSequence(currentBgFolder);
+}
+
+void CustomKBMOverlay::LoadAllImages()
+{
+	// Drop sprites from the previous layout now, the new ones stream in afterwards
+	CancelLoads(LoadStage::Keys);
+	for (const auto& binding : keyBindings) {
+		std::string key = binding.name;
 		KeyImages kImages;
-		kImages.pressed = LoadImageTemplate(key + "_pressed.png");
-		kImages.isPressed = false;
+		kImages.vk = binding.vk;
 		keys[key] = kImages;
+		QueueLoad(LoadStage::Keys, key + "_pressed.png", [this, key]() {
+			LoadKeySprite(key);
+		});
 	}
+
+	// Layout profile may have changed, follow it to the new folder
+	WatchLayoutFolder();
+}
+
+void CustomKBMOverlay::QueueOverlayLoad(const std::string& relativePath)
+{
+	// A newer design supersedes any base layer load still waiting
+	CancelLoads(LoadStage::Base);
+	QueueLoad(LoadStage::Base, "design + outlines", [this, relativePath]() {
+		LoadOverlayImage(relativePath);
+	});
+}
+
+bool CustomKBMOverlay::QueueLayoutImage(const std::string& name)
+{
+	// Re-decodes one image of the active layout; the current texture keeps drawing until its job runs
+	const std::string pressedSuffix = "_pressed.png";
+
+	if (name == fs::path(currentOverlayPath).filename().string()) {
+		if (IsQueued(LoadStage::Base, name)) return true;
+		QueueLoad(LoadStage::Base, name, [this]() {
+			LoadDesignImage();
+		});
+	}
+	else if (name == "keyboard_outlines.png") {
+		if (IsQueued(LoadStage::Base, name)) return true;
+		QueueLoad(LoadStage::Base, name, [this]() {
+			LoadOutlinesImage();
+		});
+	}
+	else if (name.size() > pressedSuffix.size() &&
+		name.compare(name.size() - pressedSuffix.size(), pressedSuffix.size(), pressedSuffix) == 0) {
+		std::string key = name.substr(0, name.size() - pressedSuffix.size());
+		if (keys.find(key) == keys.end()) return false;
+		if (IsQueued(LoadStage::Keys, name)) return true;
+		QueueLoad(LoadStage::Keys, name, [this, key]() {
+			LoadKeySprite(key);
+		});
+	}
+	else {
+		return false;
+	}
+	return true;
 }
 
 void CustomKBMOverlay::LoadOverlayImage(const std::string& relativePath)
@@ -180,25 +457,29 @@ void CustomKBMOverlay::LoadOverlayImage(const std::string& relativePath)
 	}
 	if (filename == "keyboard_template.png") filename = "keyboard_bg.png"; // Auto-upgrade
 
-	int profile = cvarManager->getCvar("kbm_layout_profile").getIntValue();
-	std::string subDir = "";
-	if (profile == 1) subDir = "layouts/wasd/";
-	else if (profile == 2) subDir = "layouts/mouse/";
-
-	std::string finalPath = "CustomKBMOverlay/" + subDir + filename;
+	currentOverlayPath = "CustomKBMOverlay/" + GetLayoutSubDir() + filename;
 
-	overlayImage = std::make_shared<ImageWrapper>(gameWrapper->GetDataFolder() / finalPath, true);
-	currentOverlayPath = finalPath;
-	outlinesImage = LoadImageTemplate("keyboard_outlines.png");
+	LoadDesignImage();
+	LoadOutlinesImage();
 }
 
 void CustomKBMOverlay::LoadBackgroundSequence(const std::string& folderName)
 {
-	std::vector<std::shared_ptr<ImageWrapper>> tempFrames;
+	currentBgFolder = folderName;
+	CancelLoads(LoadStage::Background);
+	pendingBgFrames.clear();
+	pendingBgFramePaths.clear();
+	pendingBgFrameMipLevels.clear();
+	pendingBgRemaining = 0;
+
+	// Follow the new folder right away so events always refer to currentBgFolder
+	WatchBackgroundFolder();
 	
 	if (folderName.empty()) {
 		if (bgMutex) { std::lock_guard<std::mutex> lock(*bgMutex); }
 		backgroundFrames.clear();
+		backgroundFramePaths.clear();
+		backgroundFrameMipLevels.clear();
 		currentFrameIndex = 0;
 		bgFrameTimer = 0.0f;
 		lastBgFolderStatus = "No folder entered.";
@@ -236,58 +517,277 @@ void CustomKBMOverlay::LoadBackgroundSequence(const std::string& folderName)
 		return StrCmpLogicalW(a.c_str(), b.c_str()) < 0;
 	});
 
-	for (const auto& p : paths) {
-		tempFrames.push_back(std::make_shared<ImageWrapper>(p, true));
+	// Frames stream in one at a time; the previous sequence (or the static design)
+	// keeps drawing until every frame is decoded and the whole set is swapped in
+	// Each frame is loaded at the current mip level, so a small overlay never keeps full-size frames resident
+	pendingBgFramePaths = std::move(paths);
+	pendingBgFrames.resize(pendingBgFramePaths.size());
+	pendingBgFrameMipLevels.resize(pendingBgFramePaths.size());
+	pendingBgRemaining = pendingBgFramePaths.size();
+	lastBgFolderStatus = "Loading " + std::to_string(pendingBgFramePaths.size()) + " frames...";
+
+	for (const auto& path : pendingBgFramePaths) {
+		QueueLoad(LoadStage::Background, path.filename().string(), [this, path]() {
+			LoadMipImage(path, LoadStage::Background, [this, path](std::shared_ptr<ImageWrapper> image, int level) {
+				SetBackgroundFrame(path, image, level);
+			});
+		});
 	}
+}
+
+void CustomKBMOverlay::SetBackgroundFrame(const fs::path& path, std::shared_ptr<ImageWrapper> image, int level)
+{
+	// Mips finish out of order and the sequence may have been published or rescanned
+	// since the frame was requested, so find it again by path
+	auto pending = std::find(pendingBgFramePaths.begin(), pendingBgFramePaths.end(), path);
+	if (pending != pendingBgFramePaths.end()) {
+		size_t idx = pending - pendingBgFramePaths.begin();
+		bool firstDecode = !pendingBgFrames[idx];
+		pendingBgFrames[idx] = image;
+		pendingBgFrameMipLevels[idx] = level;
+		if (firstDecode && --pendingBgRemaining == 0) PublishBackgroundSequence();
+		return;
+	}
+
+	auto it = std::find(backgroundFramePaths.begin(), backgroundFramePaths.end(), path);
+	if (it == backgroundFramePaths.end()) return;
+	size_t idx = it - backgroundFramePaths.begin();
+
+	std::lock_guard<std::mutex> lock(*bgMutex);
+	backgroundFrames[idx] = image;
+	backgroundFrameMipLevels[idx] = level;
+}
 
+void CustomKBMOverlay::PublishBackgroundSequence()
+{
 	{
-		if (bgMutex) { std::lock_guard<std::mutex> lock(*bgMutex); }
-		backgroundFrames = std::move(tempFrames);
+		std::lock_guard<std::mutex> lock(*bgMutex);
+		backgroundFrames = std::move(pendingBgFrames);
+		backgroundFramePaths = std::move(pendingBgFramePaths);
+		backgroundFrameMipLevels = std::move(pendingBgFrameMipLevels);
 		currentFrameIndex = 0;
 		bgFrameTimer = 0.0f;
 		lastBgFolderStatus = "Success! Loaded " + std::to_string(backgroundFrames.size()) + " frames.";
 	}
-	
+	pendingBgFrames.clear();
+	pendingBgFramePaths.clear();
+	pendingBgFrameMipLevels.clear();
+
 	cvarManager->log("Loaded " + std::to_string(backgroundFrames.size()) + " frames for background animation.");
 }
 
+// ---------------------------------------------------------------------------
+// Staged loading
+// ---------------------------------------------------------------------------
+
+void CustomKBMOverlay::QueueLoad(LoadStage stage, std::string name, std::function<void()> load)
+{
+	// A fresh batch starts a fresh report
+	if (loadQueue.empty()) loadTimings.clear();
+
+	// Keep the queue ordered by stage so the base layer always goes first
+	auto it = std::find_if(loadQueue.begin(), loadQueue.end(), [stage](const LoadJob& job) {
+		return job.stage > stage;
+	});
+	loadQueue.insert(it, LoadJob{ stage, std::move(name), std::move(load) });
+}
+
+bool CustomKBMOverlay::IsQueued(LoadStage stage, const std::string& name)
+{
+	return std::any_of(loadQueue.begin(), loadQueue.end(), [stage, &name](const LoadJob& job) {
+		return job.stage == stage && job.name == name;
+	});
+}
+
+void CustomKBMOverlay::CancelLoads(LoadStage stage)
+{
+	std::erase_if(loadQueue, [stage](const LoadJob& job) { return job.stage == stage; });
+}
+
+void CustomKBMOverlay::PumpLoadQueue()
+{
+	// Spend at most ~4 ms per frame decoding, but always make progress
+	auto pumpStart = std::chrono::steady_clock::now();
+	do {
+		LoadJob job = std::move(loadQueue.front());
+		loadQueue.pop_front();
+
+		auto jobStart = std::chrono::steady_clock::now();
+		job.load();
+		float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - jobStart).count();
+		loadTimings.push_back(LoadTiming{ job.stage, std::move(job.name), ms });
+	} while (!loadQueue.empty() &&
+		std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - pumpStart).count() < 4.0f);
+
+	// Only startup and layout/background switches report on their own, kbm_load_report covers the rest
+	if (loadQueue.empty() && reportLoadBatch) {
+		reportLoadBatch = false;
+		LogLoadReport(false);
+	}
+}
+
+void CustomKBMOverlay::LogLoadReport(bool perAsset)
+{
+	if (loadTimings.empty()) {
+		cvarManager->log("No assets loaded yet.");
+		return;
+	}
+
+	const char* stageNames[] = { "base layer", "key sprites", "background frames" };
+	float stageMs[3] = {};
+	float stageMax[3] = {};
+	int stageCount[3] = {};
+	float totalMs = 0.0f;
+
+	for (const auto& t : loadTimings) {
+		int s = (int)t.stage;
+		stageMs[s] += t.ms;
+		stageMax[s] = std::max(stageMax[s], t.ms);
+		stageCount[s]++;
+		totalMs += t.ms;
+		if (perAsset) cvarManager->log("  " + t.name + ": " + std::to_string(t.ms) + " ms");
+	}
+
+	cvarManager->log("Loaded " + std::to_string(loadTimings.size()) + " assets in " + std::to_string(totalMs) + " ms of game-thread time:");
+	for (int s = 0; s < 3; s++) {
+		if (stageCount[s] == 0) continue;
+		cvarManager->log("  " + std::string(stageNames[s]) + ": " + std::to_string(stageCount[s]) + " in " +
+			std::to_string(stageMs[s]) + " ms (slowest " + std::to_string(stageMax[s]) + " ms)");
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Hot reload
+// ---------------------------------------------------------------------------
+
+void CustomKBMOverlay::WatchLayoutFolder()
+{
+	if (!cvarHotReload || !cvarHotReload->getBoolValue()) {
+		layoutWatcher.Stop();
+		return;
+	}
+
+	fs::path dir = gameWrapper->GetDataFolder() / "CustomKBMOverlay" / GetLayoutSubDir();
+	if (layoutWatcher.IsWatching() && layoutWatcher.GetDirectory() == dir) return;
+	if (!fs::is_directory(dir)) {
+		layoutWatcher.Stop();
+		return;
+	}
+
+	// Watcher callbacks arrive on a background thread; textures must be loaded on the game thread
+	bool ok = layoutWatcher.Start(dir, 300, [this](const std::vector<fs::path>& changedFiles) {
+		gameWrapper->Execute([this, changedFiles](GameWrapper* gw) {
+			OnLayoutFilesChanged(changedFiles);
+		});
+	});
+	if (!ok) cvarManager->log("Hot reload: unable to watch " + dir.string());
+}
+
+void CustomKBMOverlay::WatchBackgroundFolder()
+{
+	if (!cvarHotReload || !cvarHotReload->getBoolValue() || currentBgFolder.empty()) {
+		bgWatcher.Stop();
+		return;
+	}
+
+	fs::path dir = gameWrapper->GetDataFolder() / "CustomKBMOverlay" / "backgrounds" / currentBgFolder;
+	if (bgWatcher.IsWatching() && bgWatcher.GetDirectory() == dir) return;
+	if (!fs::is_directory(dir)) {
+		bgWatcher.Stop();
+		return;
+	}
+
+	bool ok = bgWatcher.Start(dir, 300, [this](const std::vector<fs::path>& changedFiles) {
+		gameWrapper->Execute([this, changedFiles](GameWrapper* gw) {
+			OnBackgroundFilesChanged(changedFiles);
+		});
+	});
+	if (!ok) cvarManager->log("Hot reload: unable to watch " + dir.string());
+}
+
+void CustomKBMOverlay::OnLayoutFilesChanged(const std::vector<fs::path>& changedFiles)
+{
+	// Change buffer overflowed, we don't know what changed so reload the whole layout
+	// Everything goes through the load queue, so even a full re-export never stalls a frame
+	if (changedFiles.empty()) {
+		for (const auto& pair : keys) {
+			QueueLayoutImage(pair.first + "_pressed.png");
+		}
+		QueueOverlayLoad(cvarManager->getCvar(GetImageCVarName()).getStringValue());
+		cvarManager->log("Hot reload: reloading entire layout.");
+		return;
+	}
+
+	for (const auto& file : changedFiles) {
+		std::string name = file.filename().string();
+		if (QueueLayoutImage(name)) cvarManager->log("Hot reload: " + name);
+	}
+}
+
+void CustomKBMOverlay::OnBackgroundFilesChanged(const std::vector<fs::path>& changedFiles)
+{
+	fs::path bgPath = gameWrapper->GetDataFolder() / "CustomKBMOverlay" / "backgrounds" / currentBgFolder;
+
+	// While a sequence is still streaming in, changes are resolved against that pending set
+	bool streaming = !pendingBgFramePaths.empty();
+	const std::vector<fs::path>& framePaths = streaming ? pendingBgFramePaths : backgroundFramePaths;
+
+	// Frames added, removed or renamed change the sequence order, so those need a full rescan.
+	// Frames that were only rewritten in place get swapped individually.
+	bool needsRescan = changedFiles.empty();
+	std::vector<size_t> changedFrames;
+	for (const auto& file : changedFiles) {
+		if (file.extension() != ".png") continue;
+
+		fs::path fullPath = bgPath / file;
+		auto it = std::find(framePaths.begin(), framePaths.end(), fullPath);
+		if (it == framePaths.end() || !fs::exists(fullPath)) {
+			needsRescan = true;
+			break;
+		}
+		changedFrames.push_back(it - framePaths.begin());
+	}
+
+	if (needsRescan) {
+		LoadBackgroundSequence(currentBgFolder);
+		return;
+	}
+	if (changedFrames.empty()) return;
+
+	// Rewritten frames are re-decoded through the load queue, a 150-frame re-export streams in like a fresh load
+	size_t queued = 0;
+	for (size_t idx : changedFrames) {
+		// Frames of a streaming sequence that aren't decoded yet will read the new file when their job runs
+		if (streaming && !pendingBgFrames[idx]) continue;
+		QueueBackgroundFrame(framePaths[idx]);
+		queued++;
+	}
+	if (queued > 0) cvarManager->log("Hot reload: " + std::to_string(queued) + " background frame(s).");
+}
+
+void CustomKBMOverlay::QueueBackgroundFrame(const fs::path& path)
+{
+	std::string name = path.filename().string();
+	if (IsQueued(LoadStage::Background, name)) return;
+
+	QueueLoad(LoadStage::Background, name, [this, path]() {
+		LoadMipImage(path, LoadStage::Background, [this, path](std::shared_ptr<ImageWrapper> image, int level) {
+			SetBackgroundFrame(path, image, level);
+		});
+	});
+}
+
 // ---------------------------------------------------------------------------
 // Render
 // ---------------------------------------------------------------------------
 
 void CustomKBMOverlay::Render(CanvasWrapper canvas)
 {
-	keys["esc"].isPressed        = (GetAsyncKeyState(VK_ESCAPE) & 0x8000) != 0;
-	keys["1"].isPressed          = (GetAsyncKeyState('1') & 0x8000) != 0;
-	keys["2"].isPressed          = (GetAsyncKeyState('2') & 0x8000) != 0;
-	keys["3"].isPressed          = (GetAsyncKeyState('3') & 0x8000) != 0;
-	keys["4"].isPressed          = (GetAsyncKeyState('4') & 0x8000) != 0;
-	keys["5"].isPressed          = (GetAsyncKeyState('5') & 0x8000) != 0;
-	keys["tab"].isPressed        = (GetAsyncKeyState(VK_TAB) & 0x8000) != 0;
-	keys["q"].isPressed          = (GetAsyncKeyState('Q') & 0x8000) != 0;
-	keys["w"].isPressed          = (GetAsyncKeyState('W') & 0x8000) != 0;
-	keys["e"].isPressed          = (GetAsyncKeyState('E') & 0x8000) != 0;
-	keys["r"].isPressed          = (GetAsyncKeyState('R') & 0x8000) != 0;
-	keys["t"].isPressed          = (GetAsyncKeyState('T') & 0x8000) != 0;
-	keys["caps"].isPressed       = (GetAsyncKeyState(VK_CAPITAL) & 0x8000) != 0;
-	keys["a"].isPressed          = (GetAsyncKeyState('A') & 0x8000) != 0;
-	keys["s"].isPressed          = (GetAsyncKeyState('S') & 0x8000) != 0;
-	keys["d"].isPressed          = (GetAsyncKeyState('D') & 0x8000) != 0;
-	keys["f"].isPressed          = (GetAsyncKeyState('F') & 0x8000) != 0;
-	keys["g"].isPressed          = (GetAsyncKeyState('G') & 0x8000) != 0;
-	keys["shift"].isPressed      = (GetAsyncKeyState(VK_SHIFT) & 0x8000) != 0;
-	keys["z"].isPressed          = (GetAsyncKeyState('Z') & 0x8000) != 0;
-	keys["x"].isPressed          = (GetAsyncKeyState('X') & 0x8000) != 0;
-	keys["c"].isPressed          = (GetAsyncKeyState('C') & 0x8000) != 0;
-	keys["v"].isPressed          = (GetAsyncKeyState('V') & 0x8000) != 0;
-	keys["b"].isPressed          = (GetAsyncKeyState('B') & 0x8000) != 0;
-	keys["ctrl"].isPressed       = (GetAsyncKeyState(VK_CONTROL) & 0x8000) != 0;
-	keys["alt"].isPressed        = (GetAsyncKeyState(VK_MENU) & 0x8000) != 0;
-	keys["space"].isPressed      = (GetAsyncKeyState(VK_SPACE) & 0x8000) != 0;
-	keys["mouse_left"].isPressed = (GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0;
-	keys["mouse_right"].isPressed= (GetAsyncKeyState(VK_RBUTTON) & 0x8000) != 0;
-	keys["mouse_4"].isPressed    = (GetAsyncKeyState(VK_XBUTTON1) & 0x8000) != 0;
-	keys["mouse_5"].isPressed    = (GetAsyncKeyState(VK_XBUTTON2) & 0x8000) != 0;
+	if (pendingMipLevel != targetMipLevel &&
+		std::chrono::steady_clock::now() - mipLevelChangedAt > std::chrono::milliseconds(300)) {
+		ApplyMipLevel(pendingMipLevel);
+	}
+	if (!loadQueue.empty()) PumpLoadQueue();
 
 	// Calculate delta time for fade-out animations
 	auto now = std::chrono::steady_clock::now();
@@ -297,71 +797,17 @@ void CustomKBMOverlay::Render(CanvasWrapper canvas)
 
 	float fadeDuration = cvarFadeSpeed->getFloatValue();
 
-	// Update opacities and track KPM
+	// Poll keys through their cached VK codes, update opacities and track KPM
 	float nowSec = (float)std::chrono::duration<double>(now.time_since_epoch()).count();
+	UpdateKeyStates(keys, [](int vk) { return (GetAsyncKeyState(vk) & 0x8000) != 0; }, nowSec, dt, fadeDuration, kpm);
+
 	// Precompute the target color for ripples
 	LinearColor highlightColor = cvarHighlightColor->getColorValue();
 	bool rainbow = cvarRainbow->getBoolValue();
-	float rainbowSpeed = 0.5f;
-	float rainbowSat = 1.0f;
 	
-	// Game state overrides (Supersonic/Boost)
-	LinearColor baseColor = highlightColor;
-	if (rainbow) {
-		float hue = fmodf((float)nowSec * rainbowSpeed, 1.0f);
-		float c = 1.0f * rainbowSat;
-		float h = hue * 6.0f;
-		float x = c * (1.0f - fabsf(fmodf(h, 2.0f) - 1.0f));
-		float m = 1.0f - c;
-		float rC = 0, gC = 0, bC = 0;
-		if (h < 1) { rC = c; gC = x; }
-		else if (h < 2) { rC = x; gC = c; }
-		else if (h < 3) { gC = c; bC = x; }
-		else if (h < 4) { gC = x; bC = c; }
-		else if (h < 5) { rC = x; bC = c; }
-		else { rC = c; bC = x; }
-		baseColor = LinearColor(rC + m, gC + m, bC + m, 1.0f);
-	}
-	
-	if (cvarReactiveRgb->getBoolValue()) {
-		if (bIsSupersonic) {
-			
-			float pulse = (sinf((float)nowSec * 15.0f) + 1.0f) / 2.0f; 
-			LinearColor deepBlue = LinearColor(0.0f, 0.2f, 1.0f, 1.0f);
-			LinearColor brightCyan = cvarSupersonicColor->getColorValue();
-			
-			baseColor.R = deepBlue.R + (brightCyan.R - deepBlue.R) * pulse;
-			baseColor.G = deepBlue.G + (brightCyan.G - deepBlue.G) * pulse;
-			baseColor.B = deepBlue.B + (brightCyan.B - deepBlue.B) * pulse;
-			baseColor.A = 1.0f;
-		} 
-		else if (bIsBoosting) {
-			baseColor = cvarBoostColor->getColorValue();
-		}
-	}
-
-	for (auto& pair : keys) {
-		const std::string& keyName = pair.first;
-		KeyImages& state = pair.second;
-
-		if (state.isPressed) {
-			if (state.opacity < 1.0f) {
-				// Just pressed down
-				keyPressTimes.push_back(nowSec);
-			}
-			state.opacity = 1.0f;
-		} else if (fadeDuration > 0.001f) {
-			state.opacity -= (1.0f / fadeDuration) * dt;
-			if (state.opacity < 0.0f) state.opacity = 0.0f;
-		} else {
-			state.opacity = 0.0f;
-		}
-	}
-
-	// Prune KPM queue older than 60 seconds
-	while (!keyPressTimes.empty() && nowSec - keyPressTimes.front() > 60.0f) {
-		keyPressTimes.pop_front();
-	}
+	// Game state for the reactive (Supersonic/Boost) key colors
+	GameStateSample carState = gameState.Load();
+	float boostDim = cvarBoostGradient->getBoolValue() ? 0.35f + 0.65f * carState.boostAmount : 1.0f;
 
 	// Shared positioning
 	Vector2 screenSize = canvas.GetSize();
@@ -388,21 +834,21 @@ void CustomKBMOverlay::Render(CanvasWrapper canvas)
 			if (frame && frame->IsLoadedForCanvas()) {
 				canvas.SetColor(255, 255, 255, (unsigned char)(designOpacity * masterOpacity * 255.0f));
 				canvas.SetPosition(Vector2{ (int)xPos, (int)yPos });
-				canvas.DrawTexture(frame.get(), scale);
+				canvas.DrawTexture(frame.get(), scale * (float)(1 << backgroundFrameMipLevels[frameIdx]));
 			}
 		}
 		else if (overlayImage && overlayImage->IsLoadedForCanvas())
 		{
 			canvas.SetColor(255, 255, 255, (unsigned char)(designOpacity * masterOpacity * 255.0f));
 			canvas.SetPosition(Vector2{ (int)xPos, (int)yPos });
-			canvas.DrawTexture(overlayImage.get(), scale);
+			canvas.DrawTexture(overlayImage.get(), scale * (float)(1 << overlayMipLevel));
 		}
 	}
 	else if (overlayImage && overlayImage->IsLoadedForCanvas())
 	{
 		canvas.SetColor(255, 255, 255, (unsigned char)(designOpacity * masterOpacity * 255.0f));
 		canvas.SetPosition(Vector2{ (int)xPos, (int)yPos });
-		canvas.DrawTexture(overlayImage.get(), scale);
+		canvas.DrawTexture(overlayImage.get(), scale * (float)(1 << overlayMipLevel));
 	}
 
 	// 1.5 Draw static lines and text on top of the design
@@ -411,7 +857,7 @@ void CustomKBMOverlay::Render(CanvasWrapper canvas)
 		unsigned char outlineAlpha = static_cast<unsigned char>(masterOpacity * 255.0f);
 		canvas.SetColor(255, 255, 255, outlineAlpha);
 		canvas.SetPosition(Vector2{ (int)xPos, (int)yPos });
-		canvas.DrawTexture(outlinesImage.get(), scale);
+		canvas.DrawTexture(outlinesImage.get(), scale * (float)(1 << outlinesMipLevel));
 	}
 
 	// 2. Draw per-key highlight images on top (only if pressed)
@@ -444,34 +890,32 @@ void CustomKBMOverlay::Render(CanvasWrapper canvas)
 			unsigned char r = keyR, g = keyG, b = keyB;
 			if (cvarReactiveRgb->getBoolValue()) {
 				// User priority: Supersonic overrides Boost visually
-				if (bIsSupersonic) {
+				if (carState.supersonic) {
 					LinearColor mc = cvarSupersonicColor->getColorValue();
 					float pulse = (sinf(nowSec * 15.0f) + 1.0f) * 0.5f; // 0.0 to 1.0 fast pulse
 					float multiplier = 0.2f + (0.8f * pulse); // Dips down to 20% brightness
 					r = (unsigned char)(mc.R * multiplier); 
 					g = (unsigned char)(mc.G * multiplier); 
 					b = (unsigned char)(mc.B * multiplier); 
-				} else if (bIsBoosting) {
+				} else if (carState.boosting) {
+					// Optional gradient: the boost color fades toward 35% as the meter runs dry
 					LinearColor mc = cvarBoostColor->getColorValue();
-					r = (unsigned char)mc.R; g = (unsigned char)mc.G; b = (unsigned char)mc.B; 
+					r = (unsigned char)(mc.R * boostDim); g = (unsigned char)(mc.G * boostDim); b = (unsigned char)(mc.B * boostDim);
 				}
 			}
 
 			unsigned char a = static_cast<unsigned char>(masterOpacity * state.opacity * 255.0f);
 			canvas.SetColor(r, g, b, a);
 			canvas.SetPosition(Vector2{ (int)xPos, (int)yPos });
-			canvas.DrawTexture(state.pressed.get(), scale);
+			canvas.DrawTexture(state.pressed.get(), scale * (float)(1 << state.mipLevel));
 		}
 	}
 
 	// 4. Draw KPM counter if enabled
 	if (cvarShowKpm->getBoolValue()) {
-		int kpm = (int)keyPressTimes.size();
 		canvas.SetColor(255, 255, 255, static_cast<unsigned char>(masterOpacity * 255.0f));
 		canvas.SetPosition(Vector2{ (int)xPos, (int)yPos - (int)(30 * scale) });
-		
-		std::string kpmText = "KPM: " + std::to_string(keyPressTimes.size());
-		canvas.DrawString(kpmText, scale * 2.0f, scale * 2.0f);
+		canvas.DrawString(kpm.GetText(), scale * 2.0f, scale * 2.0f);
 	}
 }
 
@@ -493,7 +937,8 @@ void CustomKBMOverlay::RenderSettings()
 		std::string bgName = cvarManager->getCvar(cvName) ? cvarManager->getCvar(cvName).getStringValue() : "keyboard_bg.png";
 		gameWrapper->Execute([this, bgName](GameWrapper* gw) {
 			LoadAllImages();
-			LoadOverlayImage(bgName);
+			QueueOverlayLoad(bgName);
+			reportLoadBatch = true;
 		});
 	}
 	ImGui::Spacing();
@@ -528,6 +973,14 @@ void CustomKBMOverlay::RenderSettings()
 		cvarManager->getCvar(cvName).setValue(std::string(pathBuf));
 	}
 
+	bool hotReload = cvarManager->getCvar("kbm_hot_reload").getBoolValue();
+	if (ImGui::Checkbox("Hot Reload Assets", &hotReload)) {
+		cvarManager->getCvar("kbm_hot_reload").setValue(hotReload);
+	}
+	if (ImGui::IsItemHovered()) {
+		ImGui::SetTooltip("Watch the active layout and background folders.\nEdited PNGs are reloaded automatically.");
+	}
+
 	ImGui::Separator();
 
 	// --- Design opacity ---
@@ -575,6 +1028,20 @@ void CustomKBMOverlay::RenderSettings()
 			cvarManager->getCvar("kbm_supersonic_color").setValue(std::string(hex));
 		}
 
+		bool boostGradient = cvarManager->getCvar("kbm_boost_gradient").getBoolValue();
+		if (ImGui::Checkbox("Boost Level Gradient", &boostGradient)) {
+			cvarManager->getCvar("kbm_boost_gradient").setValue(boostGradient);
+		}
+		if (ImGui::IsItemHovered()) {
+			ImGui::SetTooltip("Boost color dims as your boost meter empties.");
+		}
+
+		float sampleRate = cvarManager->getCvar("kbm_state_sample_rate").getFloatValue();
+		ImGui::SetNextItemWidth(200.0f);
+		if (ImGui::SliderFloat("Sample Rate", &sampleRate, 1.0f, 120.0f, "%.0f Hz")) {
+			cvarManager->getCvar("kbm_state_sample_rate").setValue(sampleRate);
+		}
+
 		ImGui::Unindent(20.0f);
 	}
 
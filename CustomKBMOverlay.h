@@ -7,10 +7,16 @@
 #include <memory>
 #include <chrono>
 #include <deque>
+#include <functional>
 #include <filesystem>
 #include <algorithm>
 #include <mutex>
 #include <Shlwapi.h>
+#include <optional>
+#include "DirectoryWatcher.h"
+#include "KeyInput.h"
+#include "MipBuilder.h"
+#include "SeqLock.h"
 
 #pragma comment(lib, "Shlwapi.lib")
 
@@ -31,10 +37,9 @@ private:
 	void Render(CanvasWrapper canvas);
 
 	// Helper struct to hold pressed images for a single key
-	struct KeyImages {
+	struct KeyImages : KeyState {
 		std::shared_ptr<ImageWrapper> pressed;
-		bool isPressed = false;
-		float opacity = 0.0f;
+		int mipLevel = 0;
 	};
 
 	std::map<std::string, KeyImages> keys;
@@ -42,38 +47,118 @@ private:
 	// Base overlay / design image
 	std::shared_ptr<ImageWrapper> overlayImage;
 	std::shared_ptr<ImageWrapper> outlinesImage;
+	int overlayMipLevel = 0;
+	int outlinesMipLevel = 0;
 	std::string currentOverlayPath;
 
 	// Animated Backgrounds
 	bool bIsAnimated = false;
 	std::vector<std::shared_ptr<ImageWrapper>> backgroundFrames;
+	std::vector<fs::path> backgroundFramePaths;
+	std::vector<int> backgroundFrameMipLevels;
+	// Frames of a sequence that is still streaming in, swapped in once complete
+	std::vector<std::shared_ptr<ImageWrapper>> pendingBgFrames;
+	std::vector<fs::path> pendingBgFramePaths;
+	std::vector<int> pendingBgFrameMipLevels;
+	size_t pendingBgRemaining = 0;
 	std::unique_ptr<std::mutex> bgMutex;
 	float bgFrameTimer = 0.0f;
 	int currentFrameIndex = 0;
 	std::string lastBgFolderStatus = "No folder loaded";
+	std::string currentBgFolder;
 
-	std::shared_ptr<ImageWrapper> LoadImageTemplate(std::string filename);
+	fs::path GetLayoutImagePath(const std::string& filename);
+	void LoadDesignImage();
+	void LoadOutlinesImage();
+	void LoadKeySprite(const std::string& key);
 	void LoadAllImages();
+	void QueueOverlayLoad(const std::string& relativePath);
+	bool QueueLayoutImage(const std::string& name);
 	void LoadOverlayImage(const std::string& relativePath);
 	void LoadBackgroundSequence(const std::string& folderName);
+	void SetBackgroundFrame(const fs::path& path, std::shared_ptr<ImageWrapper> image, int level);
+	void PublishBackgroundSequence();
 	void OnSetVehicleInput(std::string eventName);
+	bool IsCachedCar(CarWrapper& car);
+	void InvalidateCarCache();
 	std::string GetImageCVarName();
+	std::string GetLayoutSubDir();
+
+	// Hot reload: watch the active layout and background folders and re-decode
+	// only the textures whose files changed
+	DirectoryWatcher layoutWatcher;
+	DirectoryWatcher bgWatcher;
+	void WatchLayoutFolder();
+	void WatchBackgroundFolder();
+	void OnLayoutFilesChanged(const std::vector<fs::path>& changedFiles);
+	void OnBackgroundFilesChanged(const std::vector<fs::path>& changedFiles);
+	void QueueBackgroundFrame(const fs::path& path);
+
+	// Staged asset loading: textures are decoded a few at a time from Render so
+	// onLoad and layout/background switches never stall the game thread.
+	// Jobs run in stage order, base layer first.
+	enum class LoadStage { Base, Keys, Background };
+	struct LoadJob {
+		LoadStage stage;
+		std::string name;
+		std::function<void()> load;
+	};
+	struct LoadTiming {
+		LoadStage stage;
+		std::string name;
+		float ms;
+	};
+	std::deque<LoadJob> loadQueue;
+	std::vector<LoadTiming> loadTimings;
+	bool reportLoadBatch = false;
+	void QueueLoad(LoadStage stage, std::string name, std::function<void()> load);
+	bool IsQueued(LoadStage stage, const std::string& name);
+	void CancelLoads(LoadStage stage);
+	void PumpLoadQueue();
+	void LogLoadReport(bool perAsset);
+
+	// Mip levels: downsampled copies in mip1/ (1/2), mip2/ (1/4) and mip3/ (1/8) next to
+	// each image, built on first use (MipBuilder) and rebuilt when the source changes.
+	// Building runs on mipBuilder's worker, only the decode goes through the load queue.
+	// Every texture remembers the level it was loaded at (the *MipLevel members) and is
+	// drawn with a compensating scale of 2^level.
+	MipBuilder mipBuilder;
+	int targetMipLevel = 0;
+	int pendingMipLevel = 0;
+	std::chrono::steady_clock::time_point mipLevelChangedAt;
+	int GetMipLevelForScale(float scale);
+	fs::path GetMipPath(const fs::path& path, int level);
+	int ResolveMipLevel(const fs::path& path);
+	using ApplyImage = std::function<void(std::shared_ptr<ImageWrapper> image, int level)>;
+	void LoadMipImage(const fs::path& path, LoadStage stage, ApplyImage apply);
+	void ApplyMipLevel(int level);
 
 	std::chrono::steady_clock::time_point lastRenderTime;
 	std::chrono::steady_clock::time_point startTime;
 
-	// Game state 
-	bool bIsSupersonic = false;
-	bool bIsBoosting = false;
+	// Game state, sampled in OnSetVehicleInput and read by Render
+	struct GameStateSample {
+		bool supersonic = false;
+		bool boosting = false;
+		float boostAmount = 0.0f; // 0.0 to 1.0
+		float speed = 0.0f;       // Unreal units per second
+	};
+	SeqLock<GameStateSample> gameState;
+	std::optional<CarWrapper> cachedCar;
+	std::optional<BoostWrapper> cachedBoost;
+	std::chrono::steady_clock::time_point lastStateSample;
+	std::chrono::steady_clock::time_point lastCarCheck;
 
 	// Cached CVars for performance
 	std::shared_ptr<CVarWrapper> cvarX, cvarY, cvarScale;
 	std::shared_ptr<CVarWrapper> cvarMasterOpacity, cvarDesignOpacity;
 	std::shared_ptr<CVarWrapper> cvarRainbow, cvarHighlightColor, cvarFadeSpeed;
 	std::shared_ptr<CVarWrapper> cvarReactiveRgb, cvarBoostColor, cvarSupersonicColor;
+	std::shared_ptr<CVarWrapper> cvarBoostGradient, cvarStateRate;
 	std::shared_ptr<CVarWrapper> cvarShowKpm, cvarLayoutProfile;
 	std::shared_ptr<CVarWrapper> cvarBgAnimation, cvarBgFolder, cvarBgFps;
+	std::shared_ptr<CVarWrapper> cvarHotReload;
 
 	// KPM tracking
-	std::deque<float> keyPressTimes;
+	KpmCounter kpm;
 };
@@ -0,0 +1,128 @@
+#include "pch.h"
+#include "DirectoryWatcher.h"
+#include <set>
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+	Stop();
+}
+
+bool DirectoryWatcher::Start(const std::filesystem::path& dir, DWORD debounceMs, Callback onChanged)
+{
+	Stop();
+
+	dirHandle = CreateFileW(dir.c_str(), FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (dirHandle == INVALID_HANDLE_VALUE) return false;
+
+	stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!stopEvent) {
+		CloseHandle(dirHandle);
+		dirHandle = INVALID_HANDLE_VALUE;
+		return false;
+	}
+
+	directory = dir;
+	debounce = debounceMs;
+	callback = std::move(onChanged);
+	running = true;
+	worker = std::thread(&DirectoryWatcher::Run, this);
+	return true;
+}
+
+void DirectoryWatcher::Stop()
+{
+	if (worker.joinable()) {
+		SetEvent(stopEvent);
+		worker.join();
+	}
+	if (stopEvent) {
+		CloseHandle(stopEvent);
+		stopEvent = nullptr;
+	}
+	if (dirHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(dirHandle);
+		dirHandle = INVALID_HANDLE_VALUE;
+	}
+	callback = nullptr;
+	directory.clear();
+}
+
+void DirectoryWatcher::Run()
+{
+	OVERLAPPED ov = {};
+	ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!ov.hEvent) {
+		running = false;
+		return;
+	}
+
+	alignas(DWORD) BYTE buffer[16 * 1024];
+	std::set<std::filesystem::path> pending;
+	bool overflowed = false;
+	bool readPending = false;
+	bool stopped = false;
+
+	while (true) {
+		if (!readPending) {
+			ResetEvent(ov.hEvent);
+			BOOL ok = ReadDirectoryChangesW(dirHandle, buffer, sizeof(buffer), FALSE,
+				FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+				nullptr, &ov, nullptr);
+			if (!ok) break;
+			readPending = true;
+		}
+
+		// Only time out while there is something waiting to be flushed
+		bool hasPending = overflowed || !pending.empty();
+		HANDLE handles[2] = { stopEvent, ov.hEvent };
+		DWORD wait = WaitForMultipleObjects(2, handles, FALSE, hasPending ? debounce : INFINITE);
+
+		if (wait == WAIT_OBJECT_0) {
+			stopped = true;
+			break;
+		}
+
+		if (wait == WAIT_TIMEOUT) {
+			std::vector<std::filesystem::path> changed;
+			if (!overflowed) changed.assign(pending.begin(), pending.end());
+			pending.clear();
+			overflowed = false;
+			if (callback) callback(changed);
+			continue;
+		}
+
+		if (wait != WAIT_OBJECT_0 + 1) break;
+
+		readPending = false;
+		DWORD bytes = 0;
+		if (!GetOverlappedResult(dirHandle, &ov, &bytes, FALSE)) break;
+
+		// Zero bytes means the kernel buffer overflowed and the individual events were lost
+		if (bytes == 0) {
+			overflowed = true;
+			continue;
+		}
+
+		BYTE* cursor = buffer;
+		while (true) {
+			auto* info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(cursor);
+			pending.insert(std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+			if (info->NextEntryOffset == 0) break;
+			cursor += info->NextEntryOffset;
+		}
+	}
+
+	if (readPending) {
+		CancelIoEx(dirHandle, &ov);
+		DWORD bytes = 0;
+		GetOverlappedResult(dirHandle, &ov, &bytes, TRUE);
+	}
+	CloseHandle(ov.hEvent);
+	running = false;
+
+	// The watch died on its own (folder deleted, handle invalidated); ask for a full
+	// rescan so the owner notices and can re-arm the watcher
+	if (!stopped && callback) callback({});
+}
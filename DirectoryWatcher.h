@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Watches a single directory (non-recursive) on a background thread using
+// ReadDirectoryChangesW. Change notifications are coalesced and only reported
+// once the directory has been quiet for the debounce interval, so a tool that
+// rewrites hundreds of frames produces one callback instead of hundreds.
+class DirectoryWatcher
+{
+public:
+	// Receives the names of changed files (relative to the watched directory).
+	// An empty list means the change buffer overflowed, or the watch was lost
+	// (e.g. the folder was deleted), and the caller should treat every file in
+	// the directory as changed and call Start again if it still wants events.
+	using Callback = std::function<void(const std::vector<std::filesystem::path>& changedFiles)>;
+
+	DirectoryWatcher() = default;
+	~DirectoryWatcher();
+
+	DirectoryWatcher(const DirectoryWatcher&) = delete;
+	DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+	bool Start(const std::filesystem::path& dir, DWORD debounceMs, Callback onChanged);
+	void Stop();
+
+	// False once the worker has exited, including after an error
+	bool IsWatching() const { return running.load(); }
+	const std::filesystem::path& GetDirectory() const { return directory; }
+
+private:
+	void Run();
+
+	std::filesystem::path directory;
+	Callback callback;
+	DWORD debounce = 300;
+	HANDLE dirHandle = INVALID_HANDLE_VALUE;
+	HANDLE stopEvent = nullptr;
+	std::thread worker;
+	std::atomic<bool> running{ false };
+};
@@ -0,0 +1,108 @@
+#pragma once
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <array>
+#include <cstdio>
+#include <string>
+
+// Key polling and KPM tracking used by Render every frame. Kept free of
+// BakkesMod types so tests/RenderAllocTest can drive it under an
+// allocation counter.
+
+// Every key the overlay can show, with the virtual key polled for it
+struct KeyBinding {
+	const char* name;
+	int vk;
+};
+
+inline constexpr KeyBinding keyBindings[] = {
+	{ "esc", VK_ESCAPE }, { "1", '1' }, { "2", '2' }, { "3", '3' }, { "4", '4' }, { "5", '5' },
+	{ "tab", VK_TAB }, { "q", 'Q' }, { "w", 'W' }, { "e", 'E' }, { "r", 'R' }, { "t", 'T' },
+	{ "caps", VK_CAPITAL }, { "a", 'A' }, { "s", 'S' }, { "d", 'D' }, { "f", 'F' }, { "g", 'G' },
+	{ "shift", VK_SHIFT }, { "z", 'Z' }, { "x", 'X' }, { "c", 'C' }, { "v", 'V' }, { "b", 'B' },
+	{ "ctrl", VK_CONTROL }, { "alt", VK_MENU }, { "space", VK_SPACE },
+	{ "mouse_left", VK_LBUTTON }, { "mouse_right", VK_RBUTTON }, { "mouse_4", VK_XBUTTON1 }, { "mouse_5", VK_XBUTTON2 }
+};
+
+struct KeyState {
+	int vk = 0;
+	bool isPressed = false;
+	float opacity = 0.0f;
+};
+
+// Keys pressed in the last 60 seconds. Timestamps live in a fixed ring buffer
+// and the "KPM: N" label is only reformatted when N changes; the label is short
+// enough to stay in the small-string buffer, so none of this touches the heap.
+class KpmCounter
+{
+public:
+	void RecordPress(float timeSec)
+	{
+		// Buffer full means more presses than it can hold in the 60 s window, drop the oldest
+		if (count == times.size()) {
+			head = (head + 1) % times.size();
+			count--;
+		}
+		times[(head + count) % times.size()] = timeSec;
+		count++;
+	}
+
+	void Prune(float nowSec)
+	{
+		while (count > 0 && nowSec - times[head] > 60.0f) {
+			head = (head + 1) % times.size();
+			count--;
+		}
+	}
+
+	int GetCount() const { return (int)count; }
+
+	const std::string& GetText()
+	{
+		int kpm = GetCount();
+		if (kpm != textValue) {
+			char buf[32];
+			int len = snprintf(buf, sizeof(buf), "KPM: %d", kpm);
+			text.assign(buf, len > 0 ? (size_t)len : 0);
+			textValue = kpm;
+		}
+		return text;
+	}
+
+private:
+	std::array<float, 4096> times = {};
+	size_t head = 0;
+	size_t count = 0;
+	std::string text;
+	int textValue = -1;
+};
+
+// Polls every key through isDown(vk), advances its fade-out and records new presses
+template <typename KeyMap, typename IsDown>
+void UpdateKeyStates(KeyMap& keys, IsDown isDown, float nowSec, float dt, float fadeDuration, KpmCounter& kpm)
+{
+	for (auto& pair : keys) {
+		KeyState& state = pair.second;
+		state.isPressed = isDown(state.vk);
+
+		if (state.isPressed) {
+			if (state.opacity < 1.0f) {
+				// Just pressed down
+				kpm.RecordPress(nowSec);
+			}
+			state.opacity = 1.0f;
+		} else if (fadeDuration > 0.001f) {
+			state.opacity -= (1.0f / fadeDuration) * dt;
+			if (state.opacity < 0.0f) state.opacity = 0.0f;
+		} else {
+			state.opacity = 0.0f;
+		}
+	}
+
+	kpm.Prune(nowSec);
+}
@@ -0,0 +1,154 @@
+#include "pch.h"
+#include "MipBuilder.h"
+#include <algorithm>
+#include <objbase.h>
+#include <wincodec.h>
+#include <wrl/client.h>
+
+#pragma comment(lib, "windowscodecs.lib")
+
+using Microsoft::WRL::ComPtr;
+namespace fs = std::filesystem;
+
+bool IsMipCurrent(const fs::path& source, const fs::path& mipPath)
+{
+	std::error_code ec;
+	auto sourceTime = fs::last_write_time(source, ec);
+	if (ec) return false;
+
+	// Cached copies (ours or from generate_mips.py) carry their source's write time. Any
+	// difference means the source was replaced, even by an older file (zip extract, Explorer copy).
+	auto mipTime = fs::last_write_time(mipPath, ec);
+	return !ec && mipTime == sourceTime;
+}
+
+static bool EncodeMip(IWICImagingFactory* factory, const fs::path& source, const fs::path& dest, int level)
+{
+	ComPtr<IWICBitmapDecoder> decoder;
+	if (FAILED(factory->CreateDecoderFromFilename(source.c_str(), nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, &decoder))) return false;
+
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (FAILED(decoder->GetFrame(0, &frame))) return false;
+
+	UINT width = 0, height = 0;
+	if (FAILED(frame->GetSize(&width, &height))) return false;
+	UINT mipWidth = (std::max)(1u, width >> level);
+	UINT mipHeight = (std::max)(1u, height >> level);
+
+	// Filter in premultiplied alpha so transparent pixels don't bleed dark fringes into key edges
+	ComPtr<IWICFormatConverter> premultiplied;
+	if (FAILED(factory->CreateFormatConverter(&premultiplied))) return false;
+	if (FAILED(premultiplied->Initialize(frame.Get(), GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom))) return false;
+
+	// Fant is WIC's area-averaging (box) filter, the right choice for integer downscales
+	ComPtr<IWICBitmapScaler> scaler;
+	if (FAILED(factory->CreateBitmapScaler(&scaler))) return false;
+	if (FAILED(scaler->Initialize(premultiplied.Get(), mipWidth, mipHeight, WICBitmapInterpolationModeFant))) return false;
+
+	ComPtr<IWICFormatConverter> straight;
+	if (FAILED(factory->CreateFormatConverter(&straight))) return false;
+	if (FAILED(straight->Initialize(scaler.Get(), GUID_WICPixelFormat32bppBGRA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom))) return false;
+
+	ComPtr<IWICStream> stream;
+	if (FAILED(factory->CreateStream(&stream))) return false;
+	if (FAILED(stream->InitializeFromFilename(dest.c_str(), GENERIC_WRITE))) return false;
+
+	ComPtr<IWICBitmapEncoder> encoder;
+	if (FAILED(factory->CreateEncoder(GUID_ContainerFormatPng, nullptr, &encoder))) return false;
+	if (FAILED(encoder->Initialize(stream.Get(), WICBitmapEncoderNoCache))) return false;
+
+	ComPtr<IWICBitmapFrameEncode> frameEncode;
+	if (FAILED(encoder->CreateNewFrame(&frameEncode, nullptr))) return false;
+	if (FAILED(frameEncode->Initialize(nullptr))) return false;
+	if (FAILED(frameEncode->SetSize(mipWidth, mipHeight))) return false;
+
+	WICPixelFormatGUID format = GUID_WICPixelFormat32bppBGRA;
+	if (FAILED(frameEncode->SetPixelFormat(&format))) return false;
+	if (FAILED(frameEncode->WriteSource(straight.Get(), nullptr))) return false;
+	if (FAILED(frameEncode->Commit())) return false;
+	return SUCCEEDED(encoder->Commit());
+}
+
+static bool BuildMip(IWICImagingFactory* factory, const fs::path& source, const fs::path& dest, int level)
+{
+	std::error_code ec;
+	auto sourceTime = fs::last_write_time(source, ec);
+	if (ec) return false;
+	fs::create_directories(dest.parent_path(), ec);
+
+	// Write to a temporary file first so a half-written mip is never picked up
+	fs::path temp = dest;
+	temp += ".tmp";
+	bool ok = EncodeMip(factory, source, temp, level);
+	if (ok) {
+		// Stamp the copy with the source's time, that's what IsMipCurrent compares against
+		fs::last_write_time(temp, sourceTime, ec);
+		if (!ec) fs::rename(temp, dest, ec);
+		ok = !ec;
+	}
+	if (!ok) fs::remove(temp, ec);
+	return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Worker
+// ---------------------------------------------------------------------------
+
+MipBuilder::~MipBuilder()
+{
+	Stop();
+}
+
+void MipBuilder::Start()
+{
+	if (worker.joinable()) return;
+	stopping = false;
+	worker = std::thread(&MipBuilder::Run, this);
+}
+
+void MipBuilder::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		jobs.clear();
+	}
+	cv.notify_all();
+	if (worker.joinable()) worker.join();
+}
+
+void MipBuilder::Request(const fs::path& source, const fs::path& mipPath, int level, Callback onDone)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.push_back(Job{ source, mipPath, level, std::move(onDone) });
+	}
+	cv.notify_one();
+}
+
+void MipBuilder::Run()
+{
+	// The worker owns its COM apartment (MTA) and one imaging factory for its whole lifetime
+	HRESULT coInit = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+	{
+		ComPtr<IWICImagingFactory> factory;
+		bool haveFactory = SUCCEEDED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&factory)));
+
+		for (;;) {
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cv.wait(lock, [this] { return stopping || !jobs.empty(); });
+				if (stopping) break;
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+
+			// The same mip may have been requested twice, or pre-baked, while this one waited
+			bool ok = IsMipCurrent(job.source, job.mipPath) ||
+				(haveFactory && BuildMip(factory.Get(), job.source, job.mipPath, job.level));
+			job.onDone(ok);
+		}
+	}
+	if (SUCCEEDED(coInit)) CoUninitialize();
+}
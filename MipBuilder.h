@@ -0,0 +1,52 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Builds downsampled copies of overlay PNGs with the Windows Imaging Component
+// on a background thread, so decoding/encoding never runs on the game thread.
+// Levels are cached on disk next to the source (mip1/ = 1/2, mip2/ = 1/4, ...)
+// and stamped with the source's write time; a copy whose time doesn't match is rebuilt.
+class MipBuilder
+{
+public:
+	// Runs on the worker thread once the request is done. ok is false if the
+	// source is missing or could not be decoded/encoded.
+	using Callback = std::function<void(bool ok)>;
+
+	MipBuilder() = default;
+	~MipBuilder();
+
+	MipBuilder(const MipBuilder&) = delete;
+	MipBuilder& operator=(const MipBuilder&) = delete;
+
+	void Start();
+	// Drops requests that haven't started yet and waits for the current one
+	void Stop();
+
+	// Makes sure `mipPath` holds an up-to-date copy of `source` downsampled by 2^level
+	void Request(const std::filesystem::path& source, const std::filesystem::path& mipPath, int level, Callback onDone);
+
+private:
+	struct Job {
+		std::filesystem::path source;
+		std::filesystem::path mipPath;
+		int level = 0;
+		Callback onDone;
+	};
+
+	void Run();
+
+	std::deque<Job> jobs;
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::thread worker;
+	bool stopping = false;
+};
+
+// True if `mipPath` exists and was built from the current version of `source`.
+// Only two stat calls, cheap enough for the game thread.
+bool IsMipCurrent(const std::filesystem::path& source, const std::filesystem::path& mipPath);
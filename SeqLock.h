@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <type_traits>
+
+// Single-writer sequence lock for small trivially copyable values.
+// The writer never blocks; readers retry if they raced with a write.
+template <typename T>
+class SeqLock
+{
+	static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+public:
+	void Store(const T& value)
+	{
+		unsigned int seq = sequence.load(std::memory_order_relaxed);
+		sequence.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		data = value;
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	T Load() const
+	{
+		T value;
+		unsigned int before, after;
+		do {
+			before = sequence.load(std::memory_order_acquire);
+			value = data;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = sequence.load(std::memory_order_relaxed);
+		} while ((before & 1) != 0 || before != after);
+		return value;
+	}
+
+private:
+	std::atomic<unsigned int> sequence{ 0 };
+	T data{};
+};
@@ -0,0 +1,56 @@
+import os
+import sys
+from PIL import Image
+
+# Optional: pre-bakes the downsampled copies the plugin otherwise builds itself on
+# first use, in mip1/ (1/2 size), mip2/ (1/4) and mip3/ (1/8) next to each PNG.
+# Handy for shipping a layout with Lanczos-filtered mips. Each copy is stamped with
+# its source's modification time; the plugin rebuilds any copy whose time doesn't
+# match, so stale output is never shown.
+MIP_LEVELS = 3
+
+def generate_mips(folder_path):
+    if not os.path.isdir(folder_path):
+        print(f"Error: Folder '{folder_path}' not found.")
+        return
+
+    print(f"Generating {MIP_LEVELS} mip levels for all PNGs in '{folder_path}'...")
+
+    count = 0
+    for filename in sorted(os.listdir(folder_path)):
+        if not filename.lower().endswith(".png"):
+            continue
+
+        file_path = os.path.join(folder_path, filename)
+        source_mtime = os.stat(file_path).st_mtime_ns
+        try:
+            with Image.open(file_path) as img:
+                if img.mode != 'RGBA':
+                    img = img.convert('RGBA')
+
+                # Each level is built from the previous one, halving both dimensions
+                level_img = img
+                for level in range(1, MIP_LEVELS + 1):
+                    size = (max(1, level_img.width // 2), max(1, level_img.height // 2))
+                    level_img = level_img.resize(size, Image.Resampling.LANCZOS)
+
+                    level_dir = os.path.join(folder_path, f"mip{level}")
+                    os.makedirs(level_dir, exist_ok=True)
+                    level_path = os.path.join(level_dir, filename)
+                    level_img.save(level_path)
+                    os.utime(level_path, ns=(source_mtime, source_mtime))
+
+                count += 1
+                if count % 10 == 0:
+                    print(f"  Processed {count} images...")
+        except Exception as e:
+            print(f"  Failed to process {filename}: {e}")
+
+    print(f"Done! Generated mips for {count} images.")
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("Usage: python generate_mips.py [layout_or_background_folder] ...")
+    else:
+        for folder in sys.argv[1:]:
+            generate_mips(folder)
@@ -0,0 +1,160 @@
+// Standalone checks for DirectoryWatcher's debounce and coalescing.
+// Creates a scratch folder in %TEMP%, touches files in it and inspects the
+// batches the watcher reports. Exit code is the number of failed checks.
+#include "pch.h"
+#include "DirectoryWatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			std::printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while (0)
+
+// Collects watcher batches so the test thread can wait for them
+struct BatchRecorder {
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::vector<std::vector<fs::path>> batches;
+
+	DirectoryWatcher::Callback Callback()
+	{
+		return [this](const std::vector<fs::path>& changedFiles) {
+			std::lock_guard<std::mutex> lock(mutex);
+			batches.push_back(changedFiles);
+			cv.notify_all();
+		};
+	}
+
+	// Waits for the first batch, then keeps listening a little longer to catch stragglers
+	std::vector<std::vector<fs::path>> Collect(std::chrono::milliseconds settle)
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait_for(lock, std::chrono::seconds(5), [this] { return !batches.empty(); });
+		cv.wait_for(lock, settle);
+		auto result = std::move(batches);
+		batches.clear();
+		return result;
+	}
+};
+
+static void TouchFile(const fs::path& path)
+{
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out << "x";
+}
+
+static bool Contains(const std::vector<fs::path>& files, const fs::path& name)
+{
+	return std::find(files.begin(), files.end(), name) != files.end();
+}
+
+static void TestSingleFileChange(const fs::path& dir)
+{
+	BatchRecorder recorder;
+	DirectoryWatcher watcher;
+	CHECK(watcher.Start(dir, 100, recorder.Callback()));
+	CHECK(watcher.IsWatching());
+
+	TouchFile(dir / "a_pressed.png");
+
+	auto batches = recorder.Collect(std::chrono::milliseconds(500));
+	CHECK(batches.size() == 1);
+	if (!batches.empty()) {
+		CHECK(batches[0].size() == 1);
+		CHECK(Contains(batches[0], "a_pressed.png"));
+	}
+}
+
+static void TestRepeatedWritesCoalesce(const fs::path& dir)
+{
+	BatchRecorder recorder;
+	DirectoryWatcher watcher;
+	CHECK(watcher.Start(dir, 200, recorder.Callback()));
+
+	// Same file rewritten many times inside the debounce window reports once
+	for (int i = 0; i < 20; i++) {
+		TouchFile(dir / "keyboard_bg.png");
+	}
+
+	auto batches = recorder.Collect(std::chrono::milliseconds(600));
+	CHECK(batches.size() == 1);
+	if (!batches.empty()) {
+		CHECK(batches[0].size() == 1);
+		CHECK(Contains(batches[0], "keyboard_bg.png"));
+	}
+}
+
+static void TestFrameExportDebounced(const fs::path& dir)
+{
+	BatchRecorder recorder;
+	DirectoryWatcher watcher;
+	CHECK(watcher.Start(dir, 300, recorder.Callback()));
+
+	// A 300-frame export must produce a single batch (or a single overflow = empty list)
+	for (int i = 0; i < 300; i++) {
+		TouchFile(dir / ("frame_" + std::to_string(i) + ".png"));
+	}
+
+	auto batches = recorder.Collect(std::chrono::milliseconds(800));
+	CHECK(batches.size() == 1);
+	if (!batches.empty()) {
+		CHECK(batches[0].empty() || batches[0].size() == 300);
+	}
+}
+
+static void TestStop(const fs::path& dir)
+{
+	BatchRecorder recorder;
+	DirectoryWatcher watcher;
+	CHECK(watcher.Start(dir, 100, recorder.Callback()));
+	watcher.Stop();
+	CHECK(!watcher.IsWatching());
+
+	// Nothing is reported once stopped
+	TouchFile(dir / "after_stop.png");
+	std::unique_lock<std::mutex> lock(recorder.mutex);
+	recorder.cv.wait_for(lock, std::chrono::milliseconds(400));
+	CHECK(recorder.batches.empty());
+}
+
+static void TestMissingDirectory(const fs::path& dir)
+{
+	DirectoryWatcher watcher;
+	CHECK(!watcher.Start(dir / "does_not_exist", 100, [](const std::vector<fs::path>&) {}));
+	CHECK(!watcher.IsWatching());
+}
+
+int main()
+{
+	fs::path root = fs::temp_directory_path() / ("kbm_watcher_test_" + std::to_string(GetCurrentProcessId()));
+
+	auto freshDir = [&root](const char* name) {
+		fs::path dir = root / name;
+		fs::create_directories(dir);
+		return dir;
+	};
+
+	TestSingleFileChange(freshDir("single"));
+	TestRepeatedWritesCoalesce(freshDir("coalesce"));
+	TestFrameExportDebounced(freshDir("export"));
+	TestStop(freshDir("stop"));
+	TestMissingDirectory(freshDir("missing"));
+
+	std::error_code ec;
+	fs::remove_all(root, ec);
+
+	if (failures == 0) std::printf("DirectoryWatcher: all checks passed\n");
+	return failures;
+}
@@ -0,0 +1,135 @@
+// Guards the steady-state Render path against heap allocations.
+// Replaces the global operator new with a counting version, then drives the
+// same key polling, fade and KPM code Render uses (KeyInput.h) across
+// thousands of simulated frames. Any allocation inside the frame loop fails
+// the test. Exit code is the number of failed checks.
+#include "KeyInput.h"
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+
+// The replacements below pair malloc with free, which GCC's new/delete matching can't see through
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static bool countAllocations = false;
+static size_t allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+	if (countAllocations) allocationCount++;
+	if (void* p = std::malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	if (countAllocations) allocationCount++;
+	return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			std::printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			failures++; \
+		} \
+	} while (0)
+
+// Stand-in for CanvasWrapper::DrawString, which takes its text by value
+static size_t DrawString(std::string text)
+{
+	return text.size();
+}
+
+// Runs `frames` simulated Render frames at 144 Hz and returns how many allocations they made.
+// pressPeriod(keyIndex) controls how often each key toggles, so presses and releases keep
+// changing the KPM value (and with it the cached label).
+template <typename PressPeriod>
+static size_t SimulateFrames(int frames, PressPeriod pressPeriod, int& maxKpm)
+{
+	std::map<std::string, KeyState> keys;
+	for (const auto& binding : keyBindings) {
+		KeyState state;
+		state.vk = binding.vk;
+		keys[binding.name] = state;
+	}
+
+	// Index VK codes so the fake key source can answer without allocating
+	int keyIndexByVk[256] = {};
+	int index = 0;
+	for (const auto& binding : keyBindings) keyIndexByVk[binding.vk & 0xFF] = index++;
+
+	KpmCounter kpm;
+	const float dt = 1.0f / 144.0f;
+	size_t drawn = 0;
+	maxKpm = 0;
+
+	allocationCount = 0;
+	countAllocations = true;
+	for (int frame = 0; frame < frames; frame++) {
+		float nowSec = 1000.0f + frame * dt;
+		auto isDown = [&](int vk) {
+			int period = pressPeriod(keyIndexByVk[vk & 0xFF]);
+			return (frame / period) % 2 == 0;
+		};
+		UpdateKeyStates(keys, isDown, nowSec, dt, 0.15f, kpm);
+
+		drawn += DrawString(kpm.GetText());
+		if (kpm.GetCount() > maxKpm) maxKpm = kpm.GetCount();
+	}
+	countAllocations = false;
+
+	CHECK(drawn > 0);
+	return allocationCount;
+}
+
+int main()
+{
+	int maxKpm = 0;
+
+	// Typical play: keys tapped every 0.1-0.5 s, KPM climbs and settles over ~70 s of frames
+	size_t allocs = SimulateFrames(10000, [](int key) { return 7 + key * 2; }, maxKpm);
+	if (allocs != 0) std::printf("typical play: %zu allocations\n", allocs);
+	CHECK(allocs == 0);
+	CHECK(maxKpm > 0);
+
+	// Key mashing: every key toggles every frame, overflowing the 4096-entry ring buffer
+	allocs = SimulateFrames(5000, [](int) { return 1; }, maxKpm);
+	if (allocs != 0) std::printf("key mashing: %zu allocations\n", allocs);
+	CHECK(allocs == 0);
+	CHECK(maxKpm == 4096);
+
+	// The counter itself must notice allocations, or the checks above prove nothing
+	allocationCount = 0;
+	countAllocations = true;
+	std::string* probe = new std::string("this string is too long for the small-string buffer");
+	countAllocations = false;
+	CHECK(allocationCount > 0);
+	delete probe;
+
+	if (failures == 0) std::printf("RenderAlloc: all checks passed\n");
+	return failures;
+}